@@ -34,6 +34,9 @@ extern "C" {
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 // -----------------------------------------
 
 // -----------------------------------------
@@ -63,6 +66,7 @@ extern "C" {
 ** FAT POINTER VECTOR DATA FORWARD DEFINITION
 */
 typedef struct _FVecData FVecData;
+typedef struct _FVecTable FVecTable;
 // -----------------------------------------
 
 // -----------------------------------------
@@ -83,6 +87,10 @@ FVECDEF void fvec_clear(void *vector, void *default_value);
 FVECDEF void fvec_map(void *vector, void(*func)(void*));
 FVECDEF void fvec_filter(void *src_vector, void **dest_vector, int(*predicate)(void*));
 FVECDEF void fvec_fold(void *vector, void *base, void(*binop)(void*, void*));
+FVECDEF void fvec_unique(void **vector, unsigned int(*hash)(void*), int(*eq)(void*, void*));
+FVECDEF void fvec_intersect(void *a_vector, void *b_vector, void **dest_vector, unsigned int(*hash)(void*), int(*eq)(void*, void*));
+FVECDEF void fvec_difference(void *a_vector, void *b_vector, void **dest_vector, unsigned int(*hash)(void*), int(*eq)(void*, void*));
+FVECDEF void fvec_group_by(void *vector, unsigned int **offsets, void **values, unsigned int(*hash)(void*), int(*eq)(void*, void*));
 FVECDEF unsigned int fvec_length(void *vector);
 FVECDEF unsigned int fvec_element_size(void *vector);
 FVECDEF unsigned int fvec_capacity(void *vector);
@@ -95,8 +103,58 @@ FVECDEF void fvec_print(void *vector, void(*print_func)(void*));
 // - FVECHELP int fvec_has_space(FVecData *v_data);
 // - FVECHELP void fvec_expand(FVecData **_v_data);
 // - FVECHELP void __fvec_expand_nr(FVecData **_v_data); // feature flag
+// - FVECHELP void *fvec_extend(void **vector, unsigned int count);
 // - FVECHELP void fvec_shrink(FVecData **_v_data);
 // - FVECHELP void __fvec_shrink_nr(FVecData **_v_data); // feature flag
+// - FVECHELP unsigned int fvec_hash_bytes(void *elem, unsigned int size);
+// - FVECHELP unsigned int fvec_hash_elem(void *elem, unsigned int size, unsigned int(*hash)(void*));
+// - FVECHELP int fvec_elem_eq(void *a, void *b, unsigned int size, int(*eq)(void*, void*));
+// - FVECHELP void fvec_table_init(FVecTable *t, unsigned int count);
+// - FVECHELP unsigned int fvec_table_probe(FVecTable *t, void *keys, unsigned int element_size, void *elem, unsigned int h, int(*eq)(void*, void*));
+// - FVECHELP void fvec_table_insert(FVecTable *t, unsigned int slot, unsigned int h, unsigned int index);
+// - FVECHELP void fvec_table_free(FVecTable *t);
+// - FVECHELP void fvec_set_op(void *a_vector, void *b_vector, void **dest_vector, unsigned int(*hash)(void*), int(*eq)(void*, void*), int keep_common);
+// -----------------------------------------
+
+// -----------------------------------------
+/*
+** COMPRESSED INTEGER VECTOR DEFINES
+*/
+#define FCVEC_BLOCK_SIZE 128 // values per packed block (fixed by the lane layout, see fcvec_unpack_lanes)
+// -----------------------------------------
+
+// -----------------------------------------
+/*
+** COMPRESSED INTEGER VECTOR DATA FORWARD DEFINITION
+*/
+typedef struct _FCVecBlock FCVecBlock;
+typedef struct _FCVecData FCVecData;
+// -----------------------------------------
+
+// -----------------------------------------
+/*
+** COMPRESSED INTEGER VECTOR FUNCTION PROTOTYPES
+*/
+FVECDEF FCVecData *fcvec(void);
+FVECDEF FCVecData *fcvec_from_fvec(void *vector);
+FVECDEF unsigned long long *fcvec_push(FCVecData *cvector);
+FVECDEF unsigned long long fcvec_get(FCVecData *cvector, unsigned int index);
+FVECDEF void fcvec_map(FCVecData *cvector, void(*func)(void*));
+FVECDEF void fcvec_fold(FCVecData *cvector, void *base, void(*binop)(void*, void*));
+FVECDEF unsigned int fcvec_length(FCVecData *cvector);
+FVECDEF unsigned int fcvec_bytes_alloc(FCVecData *cvector);
+FVECDEF void fcvec_free(FCVecData **cvector);
+// Helpers:
+// - FVECHELP unsigned int fcvec_bit_width(unsigned long long x);
+// - FVECHELP unsigned int fcvec_block_words(unsigned int width);
+// - FVECHELP unsigned int fcvec_unpack_one(unsigned int *words, unsigned int width, unsigned int i);
+// - FVECHELP void fcvec_unpack_lanes_w(unsigned int *words, unsigned int width, unsigned long long base, unsigned long long *out);
+// - FVECHELP void fcvec_unpack_lanes(unsigned int *words, unsigned int width, unsigned long long base, unsigned long long *out);
+// - FVECHELP void fcvec_pack_lanes(unsigned int *words, unsigned int width, unsigned int *in);
+// - FVECHELP unsigned long long fcvec_unpack_value(FCVecData *cv, unsigned int block, unsigned int i);
+// - FVECHELP void fcvec_unpack_block(FCVecData *cv, unsigned int block, unsigned long long *out);
+// - FVECHELP void fcvec_pack_block(FCVecBlock **blocks, unsigned int **words, unsigned long long *values);
+// - FVECHELP void fcvec_load(void *src, unsigned int element_size, unsigned int count, unsigned long long *out);
 // -----------------------------------------
 #endif // FVEC_H
 
@@ -208,6 +266,38 @@ FVECHELP void __fvec_expand_nr(FVecData **_v_data) {
   assert(v_data->bytes_alloc == (v_data->capacity * v_data->element_size));
 }
 
+/*
+** @brief:   Grow a vector by count zeroed elements in one step, reallocating at most once
+** @params:  vector {void **} - fat pointer vector to grow, count {unsigned int} - number of elements to add
+** @returns: {void *} - pointer to the first new element
+*/
+FVECHELP void *fvec_extend(void **vector, unsigned int count) {
+  FVecData *v_data = fvec_get_data(*vector);
+  unsigned int length = v_data->length + count;
+
+  if(v_data->capacity < length) {
+#ifdef FVEC_NO_RESIZE
+    fprintf(stderr, "Invalid operation in no-resize mode! No more room in vector!\n");
+    exit(1);
+#else
+    v_data->capacity = pot(length);
+    v_data->bytes_alloc = v_data->capacity * v_data->element_size;
+    v_data = realloc(v_data, sizeof(FVecData) + v_data->bytes_alloc);
+    if(v_data == NULL) {
+      fprintf(stderr, "Unable to reallocate vector after extending vector!\n");
+      exit(1);
+    }
+#endif // FVEC_NO_RESIZE
+  }
+
+  void *res = v_data->buffer + v_data->length * v_data->element_size;
+  memset(res, 0, count * v_data->element_size);
+  v_data->length = length;
+  *vector = &v_data->buffer;
+
+  return res;
+}
+
 /*
 ** @brief:   Shrink a vector's allocation if the length is a power of 2
 ** @params:  _v_data {FVecData **} - the vector to expand
@@ -606,6 +696,770 @@ FVECDEF void fvec_print(void *vector, void(*print_func)(void*)) {
 
 // -----------------------------------------
 
+// -----------------------------------------
+/*
+** HASH TABLE DATA DEFINITION
+*/
+typedef struct _FVecTable {
+  unsigned int *slots;  // fvec of key index + 1 (0 -> empty slot)
+  unsigned int *hashes; // fvec of the full hash stored in each occupied slot
+  unsigned int shift;   // 32 - log2(capacity), used to pick a home slot
+} FVecTable;
+// -----------------------------------------
+
+// -----------------------------------------
+/*
+** HASH TABLE HELPER FUNCTIONS DEFINITIONS
+*/
+
+/*
+** @brief:   Hash the raw bytes of a plain old data element
+** @params:  elem {void *} - element to hash, size {unsigned int} - size of the element in bytes
+** @returns: {unsigned int} - hash of the element
+*/
+FVECHELP unsigned int fvec_hash_bytes(void *elem, unsigned int size) {
+  unsigned char *p = elem;
+  unsigned long long h = 0x9E3779B97F4A7C15ULL ^ size;
+  unsigned long long k;
+
+  // consume 8 bytes at a time, memcpy keeps unaligned reads legal
+  while(size >= 8) {
+    memcpy(&k, p, 8);
+    h = (h ^ k) * 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 31;
+    p += 8;
+    size -= 8;
+  }
+  if(size) {
+    k = 0;
+    memcpy(&k, p, size);
+    h = (h ^ k) * 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 31;
+  }
+
+  // final avalanche so every input bit reaches the low 32 bits
+  h ^= h >> 33;
+  h *= 0x94D049BB133111EBULL;
+  h ^= h >> 29;
+
+  return (unsigned int)h;
+}
+
+/*
+** @brief:   Hash an element with the user hash, or its raw bytes if none was given
+** @params:  elem {void *} - element to hash, size {unsigned int} - size of the element, hash {unsigned int (*)(void*)} - user hash or NULL
+** @returns: {unsigned int} - hash of the element
+*/
+FVECHELP unsigned int fvec_hash_elem(void *elem, unsigned int size, unsigned int(*hash)(void*)) {
+  return hash ? hash(elem) : fvec_hash_bytes(elem, size);
+}
+
+/*
+** @brief:   Compare two elements with the user equality, or their raw bytes if none was given
+** @params:  a {void *} - first element, b {void *} - second element, size {unsigned int} - size of the elements, eq {int (*)(void*, void*)} - user equality or NULL
+** @returns: {int} - a boolean value representing whether or not the elements are equal
+*/
+FVECHELP int fvec_elem_eq(void *a, void *b, unsigned int size, int(*eq)(void*, void*)) {
+  return eq ? eq(a, b) : memcmp(a, b, size) == 0;
+}
+
+/*
+** @brief:   Create a flat open addressing table with room for count keys at under half load
+** @params:  t {FVecTable *} - table to initialize, count {unsigned int} - most keys that will be inserted
+** @returns: N/A
+*/
+FVECHELP void fvec_table_init(FVecTable *t, unsigned int count) {
+  unsigned int capacity = (count < 8) ? 16 : pot(count * 2);
+
+  // fvecci callocs, so every slot starts empty
+  t->slots = fvecci(sizeof(unsigned int), capacity);
+  t->hashes = fvecci(sizeof(unsigned int), capacity);
+  fvec_get_data(t->slots)->length = capacity;
+  fvec_get_data(t->hashes)->length = capacity;
+
+  t->shift = 32;
+  while(capacity > 1) {
+    t->shift--;
+    capacity >>= 1;
+  }
+}
+
+/*
+** @brief:   Find the slot holding an element, or the empty slot it would be inserted into
+** @params:  t {FVecTable *} - table to search, keys {void *} - vector the stored indices refer to, element_size {unsigned int} - size of each key, elem {void *} - element to find, h {unsigned int} - hash of elem, eq {int (*)(void*, void*)} - user equality or NULL
+** @returns: {unsigned int} - slot index (t->slots[slot] == 0 if elem is absent)
+*/
+FVECHELP unsigned int fvec_table_probe(FVecTable *t, void *keys, unsigned int element_size, void *elem, unsigned int h, int(*eq)(void*, void*)) {
+  unsigned int mask = fvec_length(t->slots) - 1;
+  // fibonacci hashing spreads weak user hashes (ie.. identity on ints) across the table
+  unsigned int i = (h * 2654435769u) >> t->shift;
+
+  // linear probing, the table is never more than half full so an empty slot always exists
+  while(t->slots[i]) {
+    if(t->hashes[i] == h && fvec_elem_eq(elem, keys + (t->slots[i] - 1) * element_size, element_size, eq))
+      break;
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+/*
+** @brief:   Store a key index in an empty slot found by fvec_table_probe
+** @params:  t {FVecTable *} - table to insert into, slot {unsigned int} - empty slot, h {unsigned int} - hash of the key, index {unsigned int} - index of the key in its vector
+** @returns: N/A
+*/
+FVECHELP void fvec_table_insert(FVecTable *t, unsigned int slot, unsigned int h, unsigned int index) {
+  assert(t->slots[slot] == 0 && "Slot is already occupied!");
+  t->slots[slot] = index + 1;
+  t->hashes[slot] = h;
+}
+
+/*
+** @brief:   Free the buffers behind a table
+** @params:  t {FVecTable *} - table to free
+** @returns: N/A
+*/
+FVECHELP void fvec_table_free(FVecTable *t) {
+  fvec_free((void **)&t->slots);
+  fvec_free((void **)&t->hashes);
+}
+
+/*
+** @brief:   Push the distinct elements of a that are (or are not) in b to the back of a destination vector
+** @params:  a_vector {void *} - elements to test, b_vector {void *} - elements to test against, dest_vector {void **} - target the elements are inserted into, hash {unsigned int (*)(void*)} - user hash or NULL, eq {int (*)(void*, void*)} - user equality or NULL, keep_common {int} - keep elements found in b (intersection) instead of missing from b (difference)
+** @returns: N/A
+*/
+FVECHELP void fvec_set_op(void *a_vector, void *b_vector, void **dest_vector, unsigned int(*hash)(void*), int(*eq)(void*, void*), int keep_common) {
+  assert(a_vector);
+  assert(b_vector);
+  assert(dest_vector && *dest_vector);
+  assert((hash == NULL) == (eq == NULL) && "Provide both hash and eq, or neither to compare raw bytes!");
+  FVecData *a_data = fvec_get_data(a_vector);
+  FVecData *b_data = fvec_get_data(b_vector);
+  unsigned int element_size = a_data->element_size;
+  assert(b_data->element_size == element_size && "Elements must be of the same size!");
+  assert(fvec_element_size(*dest_vector) == element_size && "Elements must be of the same size!");
+
+  FVecTable in_b;
+  fvec_table_init(&in_b, b_data->length);
+  for(unsigned int i = 0; i < b_data->length; ++i) {
+    void *curr = b_vector + i * element_size;
+    unsigned int h = fvec_hash_elem(curr, element_size, hash);
+    unsigned int slot = fvec_table_probe(&in_b, b_vector, element_size, curr, h, eq);
+    if(!in_b.slots[slot])
+      fvec_table_insert(&in_b, slot, h, i);
+  }
+
+  // tracks what was already pushed, indices are relative to where dest started
+  FVecTable out;
+  fvec_table_init(&out, a_data->length);
+  unsigned int base = fvec_length(*dest_vector);
+  unsigned int emitted = 0;
+
+  for(unsigned int i = 0; i < a_data->length; ++i) {
+    void *curr = a_vector + i * element_size;
+    unsigned int h = fvec_hash_elem(curr, element_size, hash);
+    int found = in_b.slots[fvec_table_probe(&in_b, b_vector, element_size, curr, h, eq)] != 0;
+    if(found != keep_common)
+      continue;
+
+    // dest may have moved on the last push, recompute its keys every time
+    unsigned int slot = fvec_table_probe(&out, *dest_vector + base * element_size, element_size, curr, h, eq);
+    if(out.slots[slot])
+      continue;
+
+    fvec_table_insert(&out, slot, h, emitted++);
+    memcpy(fvec_push(dest_vector), curr, element_size);
+  }
+
+  fvec_table_free(&in_b);
+  fvec_table_free(&out);
+}
+
+// -----------------------------------------
+
+// -----------------------------------------
+/*
+** HASH BASED FUNCTION DEFINITIONS
+*/
+
+/*
+** @brief:   Remove duplicate elements from a vector in place, keeping the first occurrence of each in order
+** @params:  vector {void **} - fat pointer vector to deduplicate, hash {unsigned int (*)(void*)} - element hash, eq {int (*)(void*, void*)} - element equality (pass NULL for both to compare raw bytes)
+** @returns: N/A
+*/
+FVECDEF void fvec_unique(void **vector, unsigned int(*hash)(void*), int(*eq)(void*, void*)) {
+  assert(vector && *vector);
+  assert((hash == NULL) == (eq == NULL) && "Provide both hash and eq, or neither to compare raw bytes!");
+  FVecData *v_data = fvec_get_data(*vector);
+  unsigned int element_size = v_data->element_size;
+
+  FVecTable t;
+  fvec_table_init(&t, v_data->length);
+
+  // kept elements are compacted to the front, the table indexes into that prefix
+  unsigned int kept = 0;
+  for(unsigned int i = 0; i < v_data->length; ++i) {
+    void *curr = *vector + i * element_size;
+    unsigned int h = fvec_hash_elem(curr, element_size, hash);
+    unsigned int slot = fvec_table_probe(&t, *vector, element_size, curr, h, eq);
+    if(t.slots[slot])
+      continue;
+
+    if(kept != i)
+      memcpy(*vector + kept * element_size, curr, element_size);
+    fvec_table_insert(&t, slot, h, kept++);
+  }
+
+  v_data->length = kept;
+  fvec_table_free(&t);
+}
+
+/*
+** @brief:   Push the distinct elements of a that also appear in b to the back of a destination vector
+** @params:  a_vector {void *} - elements to keep from, b_vector {void *} - elements to intersect with, dest_vector {void **} - target the elements are inserted into, hash {unsigned int (*)(void*)} - element hash, eq {int (*)(void*, void*)} - element equality (pass NULL for both to compare raw bytes)
+** @returns: N/A
+*/
+FVECDEF void fvec_intersect(void *a_vector, void *b_vector, void **dest_vector, unsigned int(*hash)(void*), int(*eq)(void*, void*)) {
+  fvec_set_op(a_vector, b_vector, dest_vector, hash, eq, 1);
+}
+
+/*
+** @brief:   Push the distinct elements of a that do not appear in b to the back of a destination vector
+** @params:  a_vector {void *} - elements to keep from, b_vector {void *} - elements to remove, dest_vector {void **} - target the elements are inserted into, hash {unsigned int (*)(void*)} - element hash, eq {int (*)(void*, void*)} - element equality (pass NULL for both to compare raw bytes)
+** @returns: N/A
+*/
+FVECDEF void fvec_difference(void *a_vector, void *b_vector, void **dest_vector, unsigned int(*hash)(void*), int(*eq)(void*, void*)) {
+  fvec_set_op(a_vector, b_vector, dest_vector, hash, eq, 0);
+}
+
+/*
+** @WARNING: !!! OFFSETS AND VALUES MUST BE EMPTY VECTORS, OFFSETS HOLDING UNSIGNED INTS AND VALUES MATCHING THE ELEMENT SIZE !!!
+**
+** @brief:   Group equal elements of a vector together, groups ordered by first appearance and stable within each group
+** @params:  vector {void *} - fat pointer vector to group, offsets {unsigned int **} - receives group count + 1 offsets, group g spanning [offsets[g], offsets[g+1]) of values, values {void **} - receives the permuted elements, hash {unsigned int (*)(void*)} - key hash, eq {int (*)(void*, void*)} - key equality (pass NULL for both to compare raw bytes)
+** @returns: N/A
+*/
+FVECDEF void fvec_group_by(void *vector, unsigned int **offsets, void **values, unsigned int(*hash)(void*), int(*eq)(void*, void*)) {
+  assert(vector);
+  assert(offsets && *offsets);
+  assert(values && *values);
+  assert((hash == NULL) == (eq == NULL) && "Provide both hash and eq, or neither to compare raw bytes!");
+  FVecData *v_data = fvec_get_data(vector);
+  unsigned int element_size = v_data->element_size;
+  unsigned int length = v_data->length;
+  assert(fvec_element_size(*offsets) == sizeof(unsigned int) && "Offsets must hold unsigned ints!");
+  assert(fvec_element_size(*values) == element_size && "Elements must be of the same size!");
+  assert(fvec_length(*offsets) == 0 && fvec_length(*values) == 0 && "Offsets and values must be empty!");
+
+  FVecTable t;
+  fvec_table_init(&t, length);
+  unsigned int *group_of = fvecci(sizeof(unsigned int), length);
+  unsigned int n_groups = 0;
+
+  // assign group ids and count each group's size into offsets[g + 1]
+  *(unsigned int *)fvec_push((void **)offsets) = 0;
+  for(unsigned int i = 0; i < length; ++i) {
+    void *curr = vector + i * element_size;
+    unsigned int h = fvec_hash_elem(curr, element_size, hash);
+    unsigned int slot = fvec_table_probe(&t, vector, element_size, curr, h, eq);
+    if(t.slots[slot]) {
+      group_of[i] = group_of[t.slots[slot] - 1];
+    } else {
+      fvec_table_insert(&t, slot, h, i);
+      group_of[i] = n_groups++;
+      *(unsigned int *)fvec_push((void **)offsets) = 0;
+    }
+    (*offsets)[group_of[i] + 1] += 1;
+  }
+
+  // prefix sum turns the counts into group start offsets
+  for(unsigned int g = 1; g <= n_groups; ++g)
+    (*offsets)[g] += (*offsets)[g - 1];
+
+  // scatter each element to the next free position of its group
+  fvec_extend(values, length);
+  unsigned int *cursor = fvec_clone(*offsets);
+  for(unsigned int i = 0; i < length; ++i)
+    memcpy(*values + cursor[group_of[i]]++ * element_size, vector + i * element_size, element_size);
+
+  fvec_free((void **)&cursor);
+  fvec_free((void **)&group_of);
+  fvec_table_free(&t);
+}
+
+// -----------------------------------------
+
+// -----------------------------------------
+/*
+** COMPRESSED INTEGER VECTOR DATA DEFINITION
+*/
+typedef struct _FCVecBlock {
+  unsigned long long base;  // frame of reference (smallest value in the block)
+  unsigned int offset;      // index of the block's first word in words
+  unsigned int width;       // bits used per packed value (0 -> all equal base)
+} FCVecBlock;
+
+typedef struct _FCVecData {
+  unsigned int length;                       // element count in the vector
+  unsigned int tail_length;                  // element count not yet packed
+  FCVecBlock *blocks;                        // fvec of packed block headers
+  unsigned int *words;                       // fvec of bit-packed deltas from each block's base
+  unsigned long long tail[FCVEC_BLOCK_SIZE]; // raw values waiting to fill a block
+} FCVecData;
+// -----------------------------------------
+
+// -----------------------------------------
+/*
+** COMPRESSED INTEGER VECTOR HELPER FUNCTIONS DEFINITIONS
+*/
+
+/*
+** Block layout:
+** value i of a block lives in lane i % FCVEC_LANES at row i / FCVEC_LANES, each
+** lane being its own bit stream of 32 bit words, interleaved word by word;
+** ie.. words 0-3 hold the first word of lanes 0-3, words 4-7 the second...
+** every lane shares the same word index and shift for a given row, so a row
+** decodes with FCVEC_LANES wide loads and uniform shifts (one SIMD register)
+**
+** widths above 32 store the low 32 bits of each delta as plain words, followed
+** by the high (width - 32) bits in the lane layout
+*/
+#define FCVEC_LANES 4
+#define FCVEC_ROWS (FCVEC_BLOCK_SIZE / FCVEC_LANES)
+// rows of width bits fill width whole words per lane, and widths above 32
+// store FCVEC_BLOCK_SIZE low words + FCVEC_LANES * (width - 32) high words,
+// both of which only hold with exactly 32 rows
+_Static_assert(FCVEC_BLOCK_SIZE == 128 && FCVEC_ROWS == 32, "Lane layout requires blocks of 128 values!");
+
+/*
+** @brief:   Count the bits needed to represent a value
+** @params:  x {unsigned long long} - value to measure
+** @returns: {unsigned int} - position of the highest set bit, plus one (0 for 0)
+*/
+FVECHELP unsigned int fcvec_bit_width(unsigned long long x) {
+  unsigned int width = 0;
+  while(x) {
+    width++;
+    x >>= 1;
+  }
+  return width;
+}
+
+/*
+** @brief:   Get the number of 32 bit words a block of a given width packs into
+** @params:  width {unsigned int} - bits per value
+** @returns: {unsigned int} - FCVEC_LANES * width (each lane packs FCVEC_ROWS (32) values of width bits into width words)
+*/
+FVECHELP unsigned int fcvec_block_words(unsigned int width) {
+  return FCVEC_LANES * width;
+}
+
+/*
+** @brief:   Extract a single value out of lane layout words
+** @params:  words {unsigned int *} - first word of the lane layout, width {unsigned int} - bits per value (1 to 32), i {unsigned int} - index of the value in the block
+** @returns: {unsigned int} - packed value
+*/
+FVECHELP unsigned int fcvec_unpack_one(unsigned int *words, unsigned int width, unsigned int i) {
+  unsigned int bit = (i / FCVEC_LANES) * width;
+  unsigned int k = (bit >> 5) * FCVEC_LANES + i % FCVEC_LANES;
+  unsigned int s = bit & 31;
+  unsigned int mask = (width == 32) ? ~0u : ((1u << width) - 1);
+
+  unsigned int d = words[k] >> s;
+  // value straddles two words; s > 0 here so the shift is well defined
+  if(s + width > 32)
+    d |= words[k + FCVEC_LANES] << (32 - s);
+
+  return d & mask;
+}
+
+/*
+** @brief:   Decode every value of a lane layout, width is constant folded by fcvec_unpack_lanes
+** @params:  words {unsigned int *} - first word of the lane layout, width {unsigned int} - bits per value (1 to 32), base {unsigned long long} - added to every value, out {unsigned long long *} - buffer of FCVEC_BLOCK_SIZE values
+** @returns: N/A
+*/
+FVECHELP void fcvec_unpack_lanes_w(unsigned int *words, unsigned int width, unsigned long long base, unsigned long long *out) {
+  unsigned int mask = (width == 32) ? ~0u : ((1u << width) - 1);
+#ifdef __SSE2__
+  // FCVEC_LANES (4) 32 bit lanes fill exactly one 128 bit register
+  __m128i mask4 = _mm_set1_epi32((int)mask);
+  __m128i base2 = _mm_set1_epi64x((long long)base);
+  __m128i zero = _mm_setzero_si128();
+#endif // __SSE2__
+
+  // fully unrolled (FCVEC_ROWS == 32), every row gets literal word offsets and shifts
+  #pragma GCC unroll 32
+  for(unsigned int row = 0; row < FCVEC_ROWS; ++row) {
+    unsigned int bit = row * width;
+    unsigned int s = bit & 31;
+    unsigned int *lo = words + (bit >> 5) * FCVEC_LANES;
+    unsigned int *hi = lo + FCVEC_LANES;
+    unsigned long long *o = out + row * FCVEC_LANES;
+
+#ifdef __SSE2__
+    __m128i v = _mm_srli_epi32(_mm_loadu_si128((__m128i *)lo), s);
+    if(s + width > 32)
+      v = _mm_or_si128(v, _mm_slli_epi32(_mm_loadu_si128((__m128i *)hi), 32 - s));
+    v = _mm_and_si128(v, mask4);
+
+    // widen the 4 lanes to 2 pairs of 64 bit values and add the frame of reference
+    _mm_storeu_si128((__m128i *)o, _mm_add_epi64(_mm_unpacklo_epi32(v, zero), base2));
+    _mm_storeu_si128((__m128i *)o + 1, _mm_add_epi64(_mm_unpackhi_epi32(v, zero), base2));
+#else
+    // shift and straddle are the same for every lane of a row
+    if(s + width > 32) {
+      for(unsigned int l = 0; l < FCVEC_LANES; ++l)
+        o[l] = base + (((lo[l] >> s) | (hi[l] << (32 - s))) & mask);
+    } else {
+      for(unsigned int l = 0; l < FCVEC_LANES; ++l)
+        o[l] = base + ((lo[l] >> s) & mask);
+    }
+#endif // __SSE2__
+  }
+}
+
+/*
+** @brief:   Decode every value of a lane layout, dispatching to a kernel specialized for the width
+** @params:  words {unsigned int *} - first word of the lane layout, width {unsigned int} - bits per value (1 to 32), base {unsigned long long} - added to every value, out {unsigned long long *} - buffer of FCVEC_BLOCK_SIZE values
+** @returns: N/A
+*/
+FVECHELP void fcvec_unpack_lanes(unsigned int *words, unsigned int width, unsigned long long base, unsigned long long *out) {
+  // a literal width lets the compiler resolve every row's offsets, shifts and straddles
+  #define FCVEC_UNPACK_CASE(w) case w: fcvec_unpack_lanes_w(words, w, base, out); break;
+  switch(width) {
+    FCVEC_UNPACK_CASE(1)  FCVEC_UNPACK_CASE(2)  FCVEC_UNPACK_CASE(3)  FCVEC_UNPACK_CASE(4)
+    FCVEC_UNPACK_CASE(5)  FCVEC_UNPACK_CASE(6)  FCVEC_UNPACK_CASE(7)  FCVEC_UNPACK_CASE(8)
+    FCVEC_UNPACK_CASE(9)  FCVEC_UNPACK_CASE(10) FCVEC_UNPACK_CASE(11) FCVEC_UNPACK_CASE(12)
+    FCVEC_UNPACK_CASE(13) FCVEC_UNPACK_CASE(14) FCVEC_UNPACK_CASE(15) FCVEC_UNPACK_CASE(16)
+    FCVEC_UNPACK_CASE(17) FCVEC_UNPACK_CASE(18) FCVEC_UNPACK_CASE(19) FCVEC_UNPACK_CASE(20)
+    FCVEC_UNPACK_CASE(21) FCVEC_UNPACK_CASE(22) FCVEC_UNPACK_CASE(23) FCVEC_UNPACK_CASE(24)
+    FCVEC_UNPACK_CASE(25) FCVEC_UNPACK_CASE(26) FCVEC_UNPACK_CASE(27) FCVEC_UNPACK_CASE(28)
+    FCVEC_UNPACK_CASE(29) FCVEC_UNPACK_CASE(30) FCVEC_UNPACK_CASE(31) FCVEC_UNPACK_CASE(32)
+    default: assert(0 && "Invalid lane width!");
+  }
+  #undef FCVEC_UNPACK_CASE
+}
+
+/*
+** @brief:   Bit-pack values into a zeroed lane layout
+** @params:  words {unsigned int *} - first word of the lane layout, width {unsigned int} - bits per value (1 to 32), in {unsigned int *} - FCVEC_BLOCK_SIZE values that fit in width bits
+** @returns: N/A
+*/
+FVECHELP void fcvec_pack_lanes(unsigned int *words, unsigned int width, unsigned int *in) {
+  for(unsigned int row = 0; row < FCVEC_ROWS; ++row) {
+    unsigned int bit = row * width;
+    unsigned int s = bit & 31;
+    unsigned int *lo = words + (bit >> 5) * FCVEC_LANES;
+
+    for(unsigned int l = 0; l < FCVEC_LANES; ++l) {
+      unsigned int d = in[row * FCVEC_LANES + l];
+      lo[l] |= d << s;
+      if(s + width > 32)
+        lo[l + FCVEC_LANES] |= d >> (32 - s);
+    }
+  }
+}
+
+/*
+** @brief:   Decode a single value of a packed block
+** @params:  cv {FCVecData *} - compressed vector, block {unsigned int} - index of the packed block, i {unsigned int} - index of the value in the block
+** @returns: {unsigned long long} - decoded value
+*/
+FVECHELP unsigned long long fcvec_unpack_value(FCVecData *cv, unsigned int block, unsigned int i) {
+  FCVecBlock *b = &cv->blocks[block];
+  unsigned int *words = cv->words + b->offset;
+
+  if(b->width == 0)
+    return b->base;
+  if(b->width <= 32)
+    return b->base + fcvec_unpack_one(words, b->width, i);
+
+  unsigned long long high = fcvec_unpack_one(words + FCVEC_BLOCK_SIZE, b->width - 32, i);
+  return b->base + ((high << 32) | words[i]);
+}
+
+/*
+** @brief:   Decode a whole packed block into a caller provided buffer
+** @params:  cv {FCVecData *} - compressed vector, block {unsigned int} - index of the packed block, out {unsigned long long *} - buffer of FCVEC_BLOCK_SIZE values
+** @returns: N/A
+*/
+FVECHELP void fcvec_unpack_block(FCVecData *cv, unsigned int block, unsigned long long *out) {
+  FCVecBlock *b = &cv->blocks[block];
+  unsigned int *words = cv->words + b->offset;
+  unsigned int width = b->width;
+  unsigned long long base = b->base;
+
+  if(width == 0) {
+    for(unsigned int i = 0; i < FCVEC_BLOCK_SIZE; ++i)
+      out[i] = base;
+    return;
+  }
+
+  if(width <= 32) {
+    fcvec_unpack_lanes(words, width, base, out);
+    return;
+  }
+
+  // high bits first, then stitch the plain low words under them
+  fcvec_unpack_lanes(words + FCVEC_BLOCK_SIZE, width - 32, 0, out);
+  for(unsigned int i = 0; i < FCVEC_BLOCK_SIZE; ++i)
+    out[i] = base + ((out[i] << 32) | words[i]);
+}
+
+/*
+** @brief:   Frame-of-reference encode and bit-pack a full block of values onto the end of a compressed vector's storage
+** @params:  blocks {FCVecBlock **} - fvec of block headers, words {unsigned int **} - fvec of packed words, values {unsigned long long *} - FCVEC_BLOCK_SIZE raw values
+** @returns: N/A
+*/
+FVECHELP void fcvec_pack_block(FCVecBlock **blocks, unsigned int **words, unsigned long long *values) {
+  unsigned long long lo = values[0];
+  unsigned long long hi = values[0];
+  for(unsigned int i = 1; i < FCVEC_BLOCK_SIZE; ++i) {
+    if(values[i] < lo) lo = values[i];
+    if(values[i] > hi) hi = values[i];
+  }
+
+  unsigned int width = fcvec_bit_width(hi - lo);
+  unsigned int offset = fvec_length(*words);
+  unsigned int *w = fvec_extend((void **)words, fcvec_block_words(width));
+
+  FCVecBlock *b = fvec_push((void **)blocks);
+  b->base = lo;
+  b->width = width;
+  b->offset = offset;
+
+  if(width == 0)
+    return;
+
+  unsigned int deltas[FCVEC_BLOCK_SIZE];
+  if(width <= 32) {
+    for(unsigned int i = 0; i < FCVEC_BLOCK_SIZE; ++i)
+      deltas[i] = values[i] - lo;
+    fcvec_pack_lanes(w, width, deltas);
+    return;
+  }
+
+  for(unsigned int i = 0; i < FCVEC_BLOCK_SIZE; ++i) {
+    unsigned long long d = values[i] - lo;
+    w[i] = (unsigned int)d;
+    deltas[i] = d >> 32;
+  }
+  fcvec_pack_lanes(w + FCVEC_BLOCK_SIZE, width - 32, deltas);
+}
+
+/*
+** @brief:   Widen count unsigned integers of element_size bytes into a buffer
+** @params:  src {void *} - first element to read, element_size {unsigned int} - size of each element (1, 2, 4 or 8), count {unsigned int} - number of elements, out {unsigned long long *} - buffer of at least count values
+** @returns: N/A
+*/
+FVECHELP void fcvec_load(void *src, unsigned int element_size, unsigned int count, unsigned long long *out) {
+  switch(element_size) {
+    case 1:
+      for(unsigned int i = 0; i < count; ++i) out[i] = ((unsigned char *)src)[i];
+      break;
+    case 2:
+      for(unsigned int i = 0; i < count; ++i) out[i] = ((unsigned short *)src)[i];
+      break;
+    case 4:
+      for(unsigned int i = 0; i < count; ++i) out[i] = ((unsigned int *)src)[i];
+      break;
+    default:
+      memcpy(out, src, count * sizeof(unsigned long long));
+      break;
+  }
+}
+
+// -----------------------------------------
+
+// -----------------------------------------
+/*
+** COMPRESSED INTEGER VECTOR FUNCTION DEFINITIONS
+*/
+
+/*
+** @WARNING: !!! BLOCK STORAGE GROWS THROUGH FVEC_PUSH, DO NOT PUSH PAST THE FIRST BLOCK IN FVEC_NO_RESIZE MODE !!!
+**
+** @brief:   Create an empty compressed integer vector
+** @params:  N/A
+** @returns: {FCVecData *} - the compressed vector
+*/
+FVECDEF FCVecData *fcvec(void) {
+  FCVecData *cv = calloc(1, sizeof(FCVecData));
+  if(cv == NULL) {
+    fprintf(stderr, "Unable to calloc compressed vector in fcvec!\n");
+    exit(1);
+  }
+
+  cv->blocks = fvec(sizeof(FCVecBlock));
+  cv->words = fvec(sizeof(unsigned int));
+
+  return cv;
+}
+
+/*
+** @WARNING: !!! ELEMENTS ARE READ AS UNSIGNED INTEGERS OF ELEMENT_SIZE BYTES (1, 2, 4 OR 8) !!!
+**
+** @brief:   Create a compressed integer vector holding the elements of a fat pointer vector
+** @params:  vector {void *} - fat pointer vector of unsigned integers
+** @returns: {FCVecData *} - the compressed vector
+*/
+FVECDEF FCVecData *fcvec_from_fvec(void *vector) {
+  assert(vector);
+  FVecData *v_data = fvec_get_data(vector);
+  unsigned int element_size = v_data->element_size;
+  unsigned int length = v_data->length;
+  assert((element_size == 1 || element_size == 2 || element_size == 4 || element_size == 8) && "Elements must be unsigned integers!");
+
+  FCVecData *cv = fcvec();
+  unsigned int n_blocks = length / FCVEC_BLOCK_SIZE;
+  if(n_blocks > 0) {
+    fvec_free((void **)&cv->blocks);
+    cv->blocks = fvecci(sizeof(FCVecBlock), n_blocks);
+  }
+
+  // pack full blocks straight from the source, only the remainder goes to tail
+  unsigned long long values[FCVEC_BLOCK_SIZE];
+  for(unsigned int b = 0; b < n_blocks; ++b) {
+    fcvec_load(v_data->buffer + b * FCVEC_BLOCK_SIZE * element_size, element_size, FCVEC_BLOCK_SIZE, values);
+    fcvec_pack_block(&cv->blocks, &cv->words, values);
+  }
+
+  cv->tail_length = length - n_blocks * FCVEC_BLOCK_SIZE;
+  fcvec_load(v_data->buffer + n_blocks * FCVEC_BLOCK_SIZE * element_size, element_size, cv->tail_length, cv->tail);
+  cv->length = length;
+
+  // nothing else will be pushed by the conversion, drop the doubling slack
+  FVecData *w_data = fvec_get_data(cv->words);
+  fvec_shrink(&w_data);
+  cv->words = (unsigned int *)&w_data->buffer;
+  FVecData *b_data = fvec_get_data(cv->blocks);
+  fvec_shrink(&b_data);
+  cv->blocks = (FCVecBlock *)&b_data->buffer;
+
+  return cv;
+}
+
+/*
+** @WARNING: !!! THE RETURNED SLOT IS ONLY VALID UNTIL THE NEXT CALL TO FCVEC_PUSH OR FCVEC_MAP !!!
+**
+** @brief:   Push a value into the compressed vector, packing the pending block once it fills up
+** @params:  cvector {FCVecData *} - compressed vector to push into
+** @returns: {unsigned long long *} - pointer to the new slot at the end of the vector
+*/
+FVECDEF unsigned long long *fcvec_push(FCVecData *cvector) {
+  assert(cvector);
+
+  if(cvector->tail_length == FCVEC_BLOCK_SIZE) {
+    fcvec_pack_block(&cvector->blocks, &cvector->words, cvector->tail);
+    cvector->tail_length = 0;
+  }
+
+  cvector->length += 1;
+  return &cvector->tail[cvector->tail_length++];
+}
+
+/*
+** @brief:   Get an element out of a compressed vector, decoding only the requested value
+** @params:  cvector {FCVecData *} - compressed vector with desired element, index {unsigned int} - index of the element
+** @returns: {unsigned long long} - element at target index
+*/
+FVECDEF unsigned long long fcvec_get(FCVecData *cvector, unsigned int index) {
+  assert(cvector);
+  assert(index < cvector->length && "Index out of bounds! Cannot access beyond length!");
+
+  unsigned int block = index / FCVEC_BLOCK_SIZE;
+  unsigned int i = index % FCVEC_BLOCK_SIZE;
+  if(block == fvec_length(cvector->blocks))
+    return cvector->tail[i];
+
+  return fcvec_unpack_value(cvector, block, i);
+}
+
+/*
+** @brief:   Maps a function onto each element of a compressed vector, re-packing every block afterwards
+** @params:  cvector {FCVecData *} - compressed vector to map, func {void (*)(void*)} - function applied to each element (an unsigned long long *)
+** @returns: N/A
+*/
+FVECDEF void fcvec_map(FCVecData *cvector, void(*func)(void*)) {
+  assert(cvector);
+  unsigned int n_blocks = fvec_length(cvector->blocks);
+  FCVecBlock *blocks = fvec(sizeof(FCVecBlock));
+  unsigned int *words = fvec(sizeof(unsigned int));
+  unsigned long long values[FCVEC_BLOCK_SIZE];
+
+  // block widths may change, so packed output goes into fresh storage
+  for(unsigned int b = 0; b < n_blocks; ++b) {
+    fcvec_unpack_block(cvector, b, values);
+    for(unsigned int i = 0; i < FCVEC_BLOCK_SIZE; ++i)
+      func(&values[i]);
+    fcvec_pack_block(&blocks, &words, values);
+  }
+
+  for(unsigned int i = 0; i < cvector->tail_length; ++i)
+    func(&cvector->tail[i]);
+
+  fvec_free((void **)&cvector->blocks);
+  fvec_free((void **)&cvector->words);
+  cvector->blocks = blocks;
+  cvector->words = words;
+}
+
+/*
+** @brief:   Perform a right fold over a compressed vector, decoding one block at a time
+** @params:  cvector {FCVecData *} - compressed vector to fold, base {void *} - what would be the result of the natural recursion, binop {void (*)(void*, void*)} - binary function to fold over each element (an unsigned long long *), storing the current result in the 2nd argument (base)
+** @returns: N/A
+*/
+FVECDEF void fcvec_fold(FCVecData *cvector, void *base, void(*binop)(void*, void*)) {
+  assert(cvector);
+  unsigned int n_blocks = fvec_length(cvector->blocks);
+  unsigned long long values[FCVEC_BLOCK_SIZE];
+
+  for(unsigned int b = 0; b < n_blocks; ++b) {
+    fcvec_unpack_block(cvector, b, values);
+    for(unsigned int i = 0; i < FCVEC_BLOCK_SIZE; ++i)
+      binop(&values[i], base);
+  }
+
+  for(unsigned int i = 0; i < cvector->tail_length; ++i)
+    binop(&cvector->tail[i], base);
+}
+
+/*
+** @brief:   Get the length of a compressed vector
+** @params:  cvector {FCVecData *} - target for length
+** @returns: {unsigned int} - length of the vector
+*/
+FVECDEF unsigned int fcvec_length(FCVecData *cvector) {
+  return cvector->length;
+}
+
+/*
+** @brief:   Get the bytes allocated by a compressed vector, including its block storage
+** @params:  cvector {FCVecData *} - target for bytes_alloc
+** @returns: {unsigned int} - total bytes held by the vector
+*/
+FVECDEF unsigned int fcvec_bytes_alloc(FCVecData *cvector) {
+  return sizeof(FCVecData)
+    + sizeof(FVecData) + fvec_bytes_alloc(cvector->blocks)
+    + sizeof(FVecData) + fvec_bytes_alloc(cvector->words);
+}
+
+/*
+** @brief:   Free a compressed vector (also sets pointer to NULL)
+** @params:  cvector {FCVecData **} - reference to compressed vector to free
+** @returns: N/A
+*/
+FVECDEF void fcvec_free(FCVecData **cvector) {
+  fvec_free((void **)&(*cvector)->blocks);
+  fvec_free((void **)&(*cvector)->words);
+  free(*cvector);
+  *cvector = NULL;
+}
+
+// -----------------------------------------
+
 #endif // FVEC_IMPLEMENTATION
 
 #ifdef __cplusplus
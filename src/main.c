@@ -20,6 +20,66 @@ void print(void *i) {
   printf("%d ", *(int*)i);
 }
 
+void add_one(void *i) {
+  *(unsigned long long*)i += 1;
+}
+
+void sum_ull(void *curr, void *rsf) {
+  *(unsigned long long*)rsf += *(unsigned long long*)curr;
+}
+
+// round trip length values spanning exactly width bits above a base through
+// both fcvec_from_fvec and fcvec_push, checking get, fold and map
+int check_fcvec(unsigned int width, unsigned int length) {
+  unsigned long long mask = (width == 64) ? ~0ULL : ((1ULL << width) - 1);
+  unsigned long long base = (width == 64) ? 0 : 1000;
+  unsigned long long *values = fvec(sizeof(unsigned long long));
+  unsigned long long expected = 0;
+
+  for(unsigned int i = 0; i < length; ++i) {
+    unsigned long long delta = (i * 0x9E3779B97F4A7C15ULL) & mask;
+    // pin each block's smallest and largest delta so it packs at exactly width bits
+    if(i % FCVEC_BLOCK_SIZE == 0) delta = 0;
+    if(i % FCVEC_BLOCK_SIZE == 1) delta = mask;
+    *(unsigned long long*)fvec_push(&values) = base + delta;
+    expected += base + delta;
+  }
+
+  FCVecData *converted = fcvec_from_fvec(values);
+  FCVecData *pushed = fcvec();
+  for(unsigned int i = 0; i < length; ++i)
+    *fcvec_push(pushed) = values[i];
+
+  int ok = fcvec_length(converted) == length && fcvec_length(pushed) == length;
+  if(length >= FCVEC_BLOCK_SIZE)
+    ok = ok && converted->blocks[0].width == width;
+
+  FCVecData *cvs[] = {converted, pushed};
+  for(int c = 0; c < 2; ++c) {
+    unsigned long long total = 0;
+    fcvec_fold(cvs[c], &total, sum_ull);
+    ok = ok && total == expected;
+    for(unsigned int i = 0; i < length; ++i)
+      ok = ok && fcvec_get(cvs[c], i) == values[i];
+
+    // the largest 64 bit value wraps to 0, changing the block's width
+    fcvec_map(cvs[c], add_one);
+    total = 0;
+    fcvec_fold(cvs[c], &total, sum_ull);
+    ok = ok && total == expected + length;
+    for(unsigned int i = 0; i < length; ++i)
+      ok = ok && fcvec_get(cvs[c], i) == values[i] + 1;
+  }
+
+  printf("fcvec width %2u, length %3u: %s\n", width, length, ok ? "ok" : "FAILED");
+
+  fcvec_free(&converted);
+  fcvec_free(&pushed);
+  fvec_free(&values);
+
+  return ok;
+}
+
 int main(void) {
   int *data = fvec(sizeof(int));
   
@@ -50,6 +110,13 @@ int main(void) {
  
   fvec_free(&data);
   fvec_free(&odds);
+
+  // two packed blocks and a partial tail per width, then a tail only vector
+  unsigned int widths[] = {0, 1, 31, 32, 33, 64};
+  int ok = 1;
+  for(int i = 0; i < 6; ++i)
+    ok = check_fcvec(widths[i], 2 * FCVEC_BLOCK_SIZE + 37) && ok;
+  ok = check_fcvec(33, 37) && ok;
   
-  return 0;
+  return ok ? 0 : 1;
 }